@@ -0,0 +1,104 @@
+/**
+ * @file corpus.h
+ * @brief Génération d'un corpus de dispositions de flotte distinctes
+ * @author Léopaul ESTOUR
+ * @date 18/10/2026
+ * @version V0.1
+ */
+#pragma once
+
+#include <fstream>
+#include <unordered_set>
+#include "joueur.h"
+
+/// Signature en tête des fichiers de corpus
+#define CORPUS_SIGNATURE "BNFL"
+/// Nombre maximum de tirages par disposition demandée avant d'abandonner
+#define CORPUS_TENTATIVES_MAX 100
+/// Nombre maximum de codes réservés d'avance dans la table des doublons
+#define CORPUS_RESERVE_MAX 10000000
+
+/**
+ * @class Corpus
+ * @brief Génère des dispositions uniformes, canoniques et sans doublon, et les écrit dans un fichier compact
+ *
+ * Format du fichier (entiers en petit-boutiste) :
+ * @code
+ * "BNFL" | DIMENSIONS (u16) | NB_BATEAUX (u16) | bits par bateau (u16) | nombre de dispositions (u64)
+ * puis pour chaque disposition son code canonique sur ceil(bits * NB_BATEAUX / 8) octets
+ * @endcode
+ * Le code se relit avec Echantillonneur::decoder.
+ */
+class Corpus {
+    private:
+        /// Échantillonneur de dispositions
+        Echantillonneur echantillonneur;
+        /// Générateur aléatoire
+        mt19937_64 gen;
+        /// Codes canoniques déjà écrits
+        unordered_set<uint64_t> vus;
+
+        /**
+         * @brief Écrit 'n' octets de 'v' en petit-boutiste
+         *
+         * @param out Flux de sortie
+         * @param v Valeur à écrire
+         * @param n Nombre d'octets
+         */
+        static void ecrire(ostream& out, uint64_t v, size_t n) {
+            for (size_t i = 0; i < n; i++) out.put(static_cast<char>((v >> (8 * i)) & 0xFF));
+        }
+
+    public:
+        /**
+         * @brief Construction d'un corpus vide
+         *
+         * @param graine Graine du générateur aléatoire
+         */
+        Corpus(uint64_t graine) : gen(graine) {}
+
+        /**
+         * @brief Génère 'nb' dispositions distinctes et les écrit dans 'chemin'
+         *
+         * S'arrête plus tôt si trop de tirages successifs sont des doublons,
+         * c'est-à-dire si 'nb' approche le nombre de dispositions légales.
+         * Les doublons ne sont recherchés que dans le fichier en cours.
+         *
+         * @param chemin Fichier de sortie
+         * @param nb Nombre de dispositions souhaité
+         * @return uint64_t Nombre de dispositions écrites
+         */
+        uint64_t generer(const string& chemin, uint64_t nb) {
+            if (!echantillonneur.codable())
+                throw length_error("Corpus::generer(): disposition trop grande pour être codée sur 64 bits");
+            ofstream out(chemin, ios::binary);
+            if (!out)
+                throw runtime_error("Corpus::generer(): impossible d'ouvrir " + chemin);
+            size_t taille = (echantillonneur.getBits() * NB_BATEAUX + 7) / 8;
+            out.write(CORPUS_SIGNATURE, 4);
+            ecrire(out, DIMENSIONS, 2);
+            ecrire(out, NB_BATEAUX, 2);
+            ecrire(out, echantillonneur.getBits(), 2);
+            streampos pos_nb = out.tellp();
+            ecrire(out, 0, 8);
+
+            vus.clear();
+            vus.reserve(static_cast<size_t>(min<uint64_t>(nb, CORPUS_RESERVE_MAX)));
+            uint64_t ecrits = 0;
+            uint64_t echecs = 0;
+            while (ecrits < nb && echecs < CORPUS_TENTATIVES_MAX && out) {
+                uint64_t code = echantillonneur.canonique(echantillonneur.tirer(gen));
+                if (vus.insert(code).second) {
+                    ecrire(out, code, taille);
+                    ecrits++;
+                    echecs = 0;
+                } else echecs++;
+            }
+            out.seekp(pos_nb);
+            ecrire(out, ecrits, 8);
+            out.flush();
+            if (!out)
+                throw runtime_error("Corpus::generer(): erreur d'écriture dans " + chemin);
+            return ecrits;
+        }
+};
@@ -9,6 +9,13 @@
 
 #include <vector>
 #include <tuple>
+#include <bitset>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_set>
+#include <thread>
 #include <iostream>
 #include <string>
 #include <cstdlib>
@@ -61,6 +68,12 @@ const vector<vector<unsigned short>> FORM_SHIP_CRUISER {{1},{1},{1}};
 const vector<vector<unsigned short>> FORM_SHIP_DESTROYER {{1},{1}};
 /// Nombre de torpilleurs
 #define FORM_SHIP_DESTROYER_NB 1
+/// Flotte de chaque joueur : {nombre de bateaux, formation en grille} pour chaque forme, du plus grand au plus petit
+const pair<unsigned short,vector<vector<unsigned short>>> FLOTTE[] = {{FORM_SHIP_CARRIER_NB,FORM_SHIP_CARRIER},{FORM_SHIP_BATTLESHIP_NB,FORM_SHIP_BATTLESHIP},{FORM_SHIP_CRUISER_NB,FORM_SHIP_CRUISER},{FORM_SHIP_DESTROYER_NB,FORM_SHIP_DESTROYER}};
+/// Nombre de formes de bateaux différentes, indicées dans l'ordre de FLOTTE
+#define NB_FORMES static_cast<int>(sizeof(FLOTTE) / sizeof(FLOTTE[0]))
+/// Nombre total de bateaux par joueur
+#define NB_BATEAUX (FORM_SHIP_CARRIER_NB + FORM_SHIP_BATTLESHIP_NB + FORM_SHIP_CRUISER_NB + FORM_SHIP_DESTROYER_NB)
 
 /// Nombre maximum d'itérations possible dans une partie
 #define ITER_MAX 100
@@ -107,6 +120,176 @@ const vector<vector<unsigned short>> FORM_SHIP_DESTROYER {{1},{1}};
  * @endcode
  */
 
+/// Ensemble des cases d'une grille, la case (y,x) étant le bit y*DIMENSIONS+x
+typedef bitset<DIMENSIONS * DIMENSIONS> Masque;
+
+/**
+ * @brief Placement d'un bateau sur la grille, dans le format attendu par Joueur::placer
+ */
+struct Placement {
+    /// Forme du bateau (indice dans FLOTTE)
+    short forme;
+    /// Centre du bateau
+    pair<int,int> coords;
+    /// Paramètres du placement {sens de parcours des lignes de la forme, sens de parcours de ses colonnes, 1 si la forme est posée telle quelle ou 0 si elle est transposée}
+    vector<int> param;
+    /// Cases occupées par le bateau
+    Masque cases;
+};
+
+/**
+ * @class Echantillonneur
+ * @brief Tirage uniforme d'une disposition de la flotte parmi toutes les dispositions légales
+ *
+ * Une disposition est légale si chaque bateau tient dans la grille et si aucun
+ * bateau n'en chevauche un autre. Chaque forme a la liste de ses placements
+ * distincts (deux placements couvrant les mêmes cases ne comptent qu'une fois).
+ * Le tirage choisit un placement uniforme par bateau et recommence si deux
+ * bateaux se chevauchent : la loi obtenue est exactement uniforme sur les
+ * dispositions légales, les bateaux de même forme étant interchangeables.
+ */
+class Echantillonneur {
+    private:
+        /// Placements distincts de chaque forme
+        vector<vector<Placement>> placements;
+        /// Forme de chaque bateau de la flotte, du plus grand au plus petit
+        vector<short> flotte;
+        /// Nombre de bits pour coder l'indice d'un placement
+        unsigned short bits;
+
+    public:
+        /**
+         * @brief Construction de la liste des placements distincts de chaque forme
+         *
+         * Les placements sont générés avec la même géométrie que Joueur::placer,
+         * pour tous les centres et les 8 orientations possibles.
+         */
+        Echantillonneur() : placements(NB_FORMES), bits(1) {
+            for (short d = 0; d < NB_FORMES; d++) {
+                const vector<vector<unsigned short>>& forme = FLOTTE[d].second;
+                unordered_set<Masque> vus;
+                for (int y = 0; y < DIMENSIONS; y++)
+                    for (int x = 0; x < DIMENSIONS; x++)
+                        for (int n : {0,1})
+                            for (int o : {+1,-1})
+                                for (int p : {+1,-1}) {
+                                    Placement pl = {d, {y, x}, {o, p, n}, Masque()};
+                                    bool possible = true;
+                                    for (int i = 0; i < static_cast<int>(forme.size()) && possible; i++)
+                                        for (int j = 0; j < static_cast<int>(forme[0].size()) && possible; j++) {
+                                            int ay = (n == 1) ? (y + i * o) : (y + j * p);
+                                            int ax = (n == 1) ? (x + j * p) : (x + i * o);
+                                            possible = (0 <= ay && ay < DIMENSIONS && 0 <= ax && ax < DIMENSIONS);
+                                            if (possible && forme[i][j] == 1) pl.cases.set(ay * DIMENSIONS + ax);
+                                        }
+                                    if (possible && vus.insert(pl.cases).second)
+                                        placements[d].push_back(pl);
+                                }
+                for (int i = 0; i < static_cast<int>(FLOTTE[d].first); i++) flotte.push_back(d);
+                while ((size_t(1) << bits) < placements[d].size()) bits++;
+            }
+        }
+
+        /**
+         * @brief Tire une disposition uniforme de la flotte
+         *
+         * @param gen Générateur aléatoire
+         * @return vector<unsigned short> Indice du placement de chaque bateau, dans l'ordre de 'getFlotte()'
+         */
+        template <class Generateur>
+        vector<unsigned short> tirer(Generateur& gen) const {
+            vector<unsigned short> rtr(flotte.size());
+            bool chevauche;
+            do {
+                Masque occupe;
+                chevauche = false;
+                for (size_t k = 0; k < flotte.size() && !chevauche; k++) {
+                    const vector<Placement>& liste = placements[flotte[k]];
+                    rtr[k] = static_cast<unsigned short>(uniform_int_distribution<size_t>(0, liste.size() - 1)(gen));
+                    chevauche = (occupe & liste[rtr[k]].cases).any();
+                    occupe |= liste[rtr[k]].cases;
+                }
+            } while (chevauche);
+            return rtr;
+        }
+        /**
+         * @brief Code une disposition sous forme canonique sur 64 bits
+         *
+         * Les bateaux de même forme sont triés, deux dispositions identiques
+         * à l'ordre près des bateaux ont donc le même code. N'est valable que
+         * si 'codable()' est vrai.
+         *
+         * @param disposition Indices des placements, dans l'ordre de 'getFlotte()'
+         * @return uint64_t Code canonique de la disposition
+         */
+        uint64_t canonique(vector<unsigned short> disposition) const {
+            for (size_t debut = 0, fin; debut < flotte.size(); debut = fin) {
+                for (fin = debut; fin < flotte.size() && flotte[fin] == flotte[debut]; fin++);
+                sort(disposition.begin() + debut, disposition.begin() + fin);
+            }
+            uint64_t rtr = 0;
+            for (size_t k = 0; k < flotte.size(); k++)
+                rtr |= static_cast<uint64_t>(disposition[k]) << (k * bits);
+            return rtr;
+        }
+        /**
+         * @brief Décode une disposition codée par 'canonique'
+         *
+         * @param code Code canonique
+         * @return vector<unsigned short> Indices des placements, dans l'ordre de 'getFlotte()'
+         */
+        vector<unsigned short> decoder(uint64_t code) const {
+            vector<unsigned short> rtr(flotte.size());
+            for (size_t k = 0; k < flotte.size(); k++)
+                rtr[k] = static_cast<unsigned short>((code >> (k * bits)) & ((uint64_t(1) << bits) - 1));
+            return rtr;
+        }
+
+        /**
+         * @brief Renvoie le placement 'i' du bateau 'k' de la flotte
+         *
+         * @param k indice du bateau dans 'getFlotte()'
+         * @param i indice du placement
+         * @return const Placement& Placement renvoyé
+         */
+        const Placement& placement(size_t k, unsigned short i) const { return placements[flotte[k]][i]; }
+        /**
+         * @brief Getter de 'flotte'
+         *
+         * @return const vector<short>& Forme de chaque bateau de la flotte
+         */
+        const vector<short>& getFlotte() const { return flotte; }
+        /**
+         * @brief Getter de 'bits'
+         *
+         * @return unsigned short Nombre de bits par bateau dans le code canonique
+         */
+        unsigned short getBits() const { return bits; }
+        /**
+         * @brief Renvoie si une disposition de la flotte tient dans un code canonique de 64 bits
+         *
+         * @return true La flotte peut être codée par 'canonique'
+         * @return false La flotte a trop de bateaux ou de placements pour 64 bits
+         */
+        bool codable() const { return bits * flotte.size() <= 64; }
+};
+
+/**
+ * @brief Résultat d'un tir réalisé pendant un tour
+ */
+struct Tir {
+    /// Ligne visée, -1 si aucun tir n'a été réalisé
+    int y = -1;
+    /// Colonne visée, -1 si aucun tir n'a été réalisé
+    int x = -1;
+    /// Booléen de si un bateau ennemi a été touché
+    bool touche = false;
+    /// Forme du bateau coulé par ce tir (indice dans FLOTTE), -1 si aucun
+    short forme_coulee = -1;
+    /// Rang du bateau coulé parmi les bateaux de l'ennemi (1 pour le premier), -1 si aucun
+    short rang = -1;
+};
+
  /**
   * @class Joueur
   * @brief Représente un joueur, sa grille et tout ce qui lui permet de jouer
@@ -117,19 +300,22 @@ class Joueur {
         vector<vector<unsigned short>> grille;
         /// Grille des tirs réalisés sur l'ennemi
         vector<vector<unsigned short>> grille_check;
+        /// Grille des indices de bateau dans 'bateaux_places', -1 si aucun bateau
+        vector<vector<short>> grille_bateaux;
+        /// Bateaux placés : {forme, nombre de cases restantes à toucher}
+        vector<pair<short,unsigned short>> bateaux_places;
+        /// Nombre de bateaux du joueur coulés
+        unsigned short nb_coules;
         /// Numéro unique du joueur
         unsigned short num_joueur;
         /// Booléen de si le joueur est un robot ou non
         bool isBot;
         /// Booléen de si le joueur a perdu, utile pour les parties à plus de 2 joueurs
         bool lost;
+        /// Booléen de si le joueur affiche ses grilles et ses tirs
+        bool verbeux;
 
     public:
-        /// Variable static définissant le nombre actuel de joueur créé, utile pour le 'num_joueur'
-        static unsigned short nb_joueurs;
-        /// Nombre actuel de joueurs ayant perdu
-        static unsigned short nb_lost;
-
         /**
          * @brief Construction d'un joueur
          * 
@@ -137,10 +323,13 @@ class Joueur {
          * Puis lance le positionnement automatique ou non des bateaux
          * 
          * @param _isBot Définit si le joueur est un robot ou un humain
+         * @param _num Numéro du joueur dans sa partie
+         * @param _verbeux Définit si le joueur affiche ses grilles et ses tirs
          */
-        Joueur(bool _isBot = true) : num_joueur(nb_joueurs++), isBot(_isBot), lost(false) {
+        Joueur(bool _isBot = true, unsigned short _num = 0, bool _verbeux = true) : nb_coules(0), num_joueur(_num), isBot(_isBot), lost(false), verbeux(_verbeux) {
             grille = vector<vector<unsigned short>>(DIMENSIONS, vector<unsigned short>(DIMENSIONS, EMPTY));
             grille_check = vector<vector<unsigned short>>(DIMENSIONS, vector<unsigned short>(DIMENSIONS, EMPTY));
+            grille_bateaux = vector<vector<short>>(DIMENSIONS, vector<short>(DIMENSIONS, -1));
             if (_isBot) random_ships();
             else position_ships();
         }
@@ -182,6 +371,9 @@ class Joueur {
             //     throw length_error("Les grilles ne font pas la même taille");
             grille = vector<vector<unsigned short>>(a.size(), vector<unsigned short>(a[0].size(), EMPTY));
             grille_check = vector<vector<unsigned short>>(a.size(), vector<unsigned short>(a[0].size(), EMPTY));
+            grille_bateaux = a.grille_bateaux;
+            bateaux_places = a.bateaux_places;
+            nb_coules = a.nb_coules;
             for (int i=0; i< static_cast<int>(grille.size());i++)
                 for (int j=0; j< static_cast<int>(grille[0].size()); j++) {
                     this->grille[i][j] = a(i, j);
@@ -193,15 +385,19 @@ class Joueur {
          * @brief Fais faire un tour au joueur
          * 
          * @param ennemi joueur à attaquer
+         * @return Tir Résultat du tir réalisé, y et x à -1 si le joueur a déjà perdu
          */
-        void play(Joueur& ennemi) {
+        Tir play(Joueur& ennemi) {
+            Tir tir;
             // display(grille);
             // display(grille_check);
-            afficherGrille(grille, true);
-            afficherGrille(grille_check, true);
-            if (hasLost())
-                cout << num_joueur << " a perdu" << endl;
-            else {
+            if (verbeux) {
+                afficherGrille(grille, true);
+                afficherGrille(grille_check, true);
+            }
+            if (hasLost()) {
+                if (verbeux) cout << num_joueur << " a perdu" << endl;
+            } else {
                 int y = -1;
                 int x = -1;
                 string xs;
@@ -210,16 +406,24 @@ class Joueur {
                     demande("Quelle colonne attaquer ?", xs, "A", colonne(this[0].size()));
                     x = invColonne(xs);
                 } else {
+                    uniform_int_distribution<int> ligne(0, size() - 1);
+                    uniform_int_distribution<int> col(0, static_cast<int>(grille_check[0].size()) - 1);
                     do {
-                        y = rand() % size();
-                        x = rand() % this[0].size();
+                        y = ligne(generateur());
+                        x = col(generateur());
                     } while (grille_check[y][x] != EMPTY);
                 }
+                tir.y = y;
+                tir.x = x;
                 if (ennemi.isTouched(y, x)) {
-                    cout << num_joueur << (hasDrowned(y,x) ? " a coulé " : " a touché ")  << ennemi.num_joueur << " en " << x << y << endl;
+                    tir.touche = true;
+                    tir.forme_coulee = ennemi.formeCoulee(y, x);
+                    if (tir.forme_coulee >= 0) tir.rang = ennemi.nb_coules;
+                    if (verbeux) cout << num_joueur << (tir.forme_coulee >= 0 ? " a coulé " : " a touché ")  << ennemi.num_joueur << " en " << x << y << endl;
                     grille_check[y][x] = CHECK;
                 } else grille_check[y][x] = CROSS;
             }
+            return tir;
         }
         /**
          * @brief Demande au joueur un entier compris entre 'min' et 'max'
@@ -256,9 +460,8 @@ class Joueur {
         void position_ships() {
             pair<int,int> coords;
             vector<vector<int>> placements;
-            vector<pair<unsigned short,vector<vector<unsigned short>>>> bateaux = {{FORM_SHIP_CARRIER_NB,FORM_SHIP_CARRIER},{FORM_SHIP_BATTLESHIP_NB,FORM_SHIP_BATTLESHIP},{FORM_SHIP_CRUISER_NB,FORM_SHIP_CRUISER},{FORM_SHIP_DESTROYER_NB,FORM_SHIP_DESTROYER}};
-            for (size_t d = 0; d < bateaux.size(); d++)
-                for (int i = 0; i < static_cast<int>(bateaux[d].first); i++) {
+            for (short d = 0; d < NB_FORMES; d++)
+                for (int i = 0; i < static_cast<int>(FLOTTE[d].first); i++) {
                     string x;
                     int n;
                     // display(grille);
@@ -267,7 +470,7 @@ class Joueur {
                         demande("Quelle ligne placer ?", coords.first, 1, size());
                         demande("Quelle colonne placer ?", x, "A", colonne(this[0].size())); coords.second = invColonne(x);
                     } while (at(coords) != EMPTY); // system("cls");
-                    placements = placementPossibles(coords.first-=1, coords.second-=1,bateaux[d].second.size(),bateaux[d].second[0].size());
+                    placements = placementPossibles(coords.first-=1, coords.second-=1,FLOTTE[d].second.size(),FLOTTE[d].second[0].size());
                     // display(grille);
                     afficherGrille(grille, true);
                     demande("",n,1,placements.size());
@@ -275,35 +478,25 @@ class Joueur {
                         for (auto x : y)
                             if (x == COORD_CENTER || x == COORD_POSSIBLE)
                                 x = EMPTY;
-                    placer(coords,placements[n-=1],bateaux[d].second);
+                    placer(coords,placements[n-=1],FLOTTE[d].second,d);
                     // system("cls");
                 }
         }
         /**
          * @brief Positionnement aléatoire des bateaux
          * 
+         * Tire une disposition uniforme parmi toutes les dispositions légales de la flotte
          */
         void random_ships() {
-            pair<int,int> coords;
-            vector<vector<int>> placements;
-            vector<pair<unsigned short,vector<vector<unsigned short>>>> bateaux = {{FORM_SHIP_CARRIER_NB,FORM_SHIP_CARRIER},{FORM_SHIP_BATTLESHIP_NB,FORM_SHIP_BATTLESHIP},{FORM_SHIP_CRUISER_NB,FORM_SHIP_CRUISER},{FORM_SHIP_DESTROYER_NB,FORM_SHIP_DESTROYER}};
-            for (int d=0; d< static_cast<int>(bateaux.size());d++)
-                for (int i = 0; i<bateaux[d].first;i++) {
-                    // display(grille);
-                    afficherGrille(grille, true);
-                    do {
-                        coords = {rand()%DIMENSIONS,rand()%DIMENSIONS};
-                    } while (at(coords) != EMPTY);
-                    do {
-                        placements = placementPossibles(coords.first, coords.second, bateaux[d].second.size(), bateaux[d].second[0].size());
-					} while (placements.empty());
-                    
-                    display(grille, placements);
-                    // display(grille);
-                    afficherGrille(grille, true);
-                    placer(coords,placements[rand()%placements.size()],bateaux[d].second);
-                    // system("cls");
-                }
+            static const Echantillonneur echantillonneur;
+            mt19937& gen = generateur();
+            vector<unsigned short> disposition = echantillonneur.tirer(gen);
+            for (size_t k = 0; k < disposition.size(); k++) {
+                const Placement& p = echantillonneur.placement(k, disposition[k]);
+                placer(p.coords, p.param, FLOTTE[p.forme].second, p.forme);
+            }
+            // display(grille);
+            if (verbeux) afficherGrille(grille, true);
         }
         /**
          * @brief Calcul des position possible du bateau en fonction de ses dimensions et des limites et autres bateaux avoisinnant
@@ -349,13 +542,24 @@ class Joueur {
          * @brief Placement du bateau
          * 
          * @param coords Centre du bateau
-         * @param param Paramètres du placement possible {direction horizontale, direction verticale, lecture horizontale ou verticale}
+         * @param param Paramètres du placement possible {sens de parcours des lignes de la forme, sens de parcours de ses colonnes, 1 si la forme est posée telle quelle ou 0 si elle est transposée}
          * @param forme Forme du bateau à placer
+         * @param type Indice de la forme dans FLOTTE, -1 si inconnu
          */
-        void placer(pair<int,int> coords, vector<int> param, vector<vector<unsigned short>> forme) {
+        void placer(pair<int,int> coords, vector<int> param, vector<vector<unsigned short>> forme, short type = -1) {
+            short id = static_cast<short>(bateaux_places.size());
+            unsigned short cases = 0;
             for (int i = 0; i < static_cast<int>(forme.size()); i++)
-                for (int j = 0; j < static_cast<int>(forme[0].size()); j++)
-                    at(((param[2] == 1) ? (coords.first + i * param[0]) : (coords.first + j * param[1])), ((param[2] == 1) ? (coords.second + j * param[1]) : (coords.second + i * param[0]))) = (forme[i][j] == 1 ? SHIP : EMPTY);
+                for (int j = 0; j < static_cast<int>(forme[0].size()); j++) {
+                    int ay = (param[2] == 1) ? (coords.first + i * param[0]) : (coords.first + j * param[1]);
+                    int ax = (param[2] == 1) ? (coords.second + j * param[1]) : (coords.second + i * param[0]);
+                    if (forme[i][j] == 1) {
+                        at(ay, ax) = SHIP;
+                        grille_bateaux[ay][ax] = id;
+                        cases++;
+                    }
+                }
+            bateaux_places.push_back({type, cases});
         }
 
         /**
@@ -368,10 +572,26 @@ class Joueur {
          */
         bool isTouched(int y, int x) {
             bool rtr = at(y,x) == SHIP;
-            if (rtr)
+            if (rtr) {
                 at(y,x) = DROWNED_SHIP;
+                short id = grille_bateaux[y][x];
+                if (id >= 0 && bateaux_places[id].second > 0 && --bateaux_places[id].second == 0)
+                    nb_coules++;
+            }
             return rtr;
         }
+        /**
+         * @brief Renvoie la forme du bateau à la position (y,x) s'il est entièrement coulé
+         * 
+         * @param y ligne souhaitée
+         * @param x colonne souhaitée
+         * @return short Indice de la forme dans FLOTTE, -1 si aucun bateau coulé
+         */
+        short formeCoulee(int y, int x) {
+            short id = grille_bateaux[y][x];
+            if (id < 0 || bateaux_places[id].second > 0) return -1;
+            return bateaux_places[id].first;
+        }
         /**
          * @brief Vérifie si le bateau à la poisition (x,y) à coulé
          * 
@@ -391,18 +611,14 @@ class Joueur {
         /**
          * @brief Renvoie si le joueur à perdu après vérification, si oui, met à jour 'lost' et 'hasLost'
          * 
+         * Le joueur a perdu quand tous ses bateaux placés sont coulés
+         * 
          * @return true Le joueur à perdu
          * @return false Le joueur n'a pas encore perdu
          */
         bool hasLost() {
-            if (!lost) {
-                short rtr = true;
-                for (int i = 0; i < size() && rtr; i++)
-                    for (int j = 0 ; j< static_cast<int>(this[0].size()) && rtr;j++)
-                        rtr = at(i,j) == num_joueur;
-                lost = rtr == 0;
-                if (lost) nb_lost++;
-            }
+            if (!lost)
+                lost = nb_coules == bateaux_places.size();
             return lost;
         }
 
@@ -459,8 +675,10 @@ class Joueur {
         void reset() {
             grille = vector<vector<unsigned short>>(DIMENSIONS, vector<unsigned short>(DIMENSIONS, EMPTY));
             grille_check = vector<vector<unsigned short>>(DIMENSIONS, vector<unsigned short>(DIMENSIONS, EMPTY));
+            grille_bateaux = vector<vector<short>>(DIMENSIONS, vector<short>(DIMENSIONS, -1));
+            bateaux_places.clear();
+            nb_coules = 0;
             lost = false;
-            nb_lost = 0;
         }
         /**
          * @brief Getter du 'num_joueur'
@@ -468,6 +686,22 @@ class Joueur {
          * @return const short Valeur de 'num_joueur'
          */
         const short getNum_joueur() { return num_joueur; }
+        /**
+         * @brief Renvoie le générateur aléatoire propre au thread courant
+         * 
+         * Initialisé au premier appel à partir de random_device et de l'identifiant du thread,
+         * pour que des joueurs créés sur plusieurs threads ne partagent pas d'état
+         * 
+         * @return mt19937& Générateur du thread
+         */
+        static mt19937& generateur() {
+            thread_local mt19937 gen = [] {
+                random_device rd;
+                seed_seq graine {rd(), rd(), rd(), rd(), static_cast<unsigned int>(hash<thread::id>()(this_thread::get_id()))};
+                return mt19937(graine);
+            }();
+            return gen;
+        }
 
         /**
          * @brief Renvoie la colonne associé à un entier
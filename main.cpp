@@ -9,42 +9,90 @@
  * 
  */
 #include <ctime>
+#include <chrono>
 #include <windows.h>
 #include "joueur.h"
+#include "statistiques.h"
+#include "partie.h"
+#include "corpus.h"
 
-/// Initialisation du nombre de joueurs créés
-unsigned short Joueur::nb_joueurs = 0;
-/// Initialisation du nombre de joueurs ayant perdu
-unsigned short Joueur::nb_lost = 0;
-
+/**
+ * @brief Lit un entier positif écrit en décimal
+ * 
+ * @param texte Texte à lire
+ * @param out Valeur lue
+ * @return true Le texte est un entier valide
+ * @return false Le texte est vide, contient autre chose que des chiffres ou dépasse 64 bits
+ */
+bool lireEntier(const string& texte, uint64_t& out) {
+    if (texte.empty() || texte.find_first_not_of("0123456789") != string::npos) return false;
+    try {
+        out = stoull(texte);
+    } catch (const out_of_range&) {
+        return false;
+    }
+    return true;
+}
 
 /**
  * @brief Programme principal faisant fonctionner la bataille navale et initialisant les joueurs
  * 
+ * Avec les arguments '--corpus <nombre> [fichier] [graine]', génère un corpus de dispositions de flotte au lieu de jouer.
+ * Avec les arguments '--parties <nombre> [threads]', joue un lot de parties sans affichage sur plusieurs threads.
+ * 
+ * @param argc Nombre d'arguments
+ * @param argv Arguments de la ligne de commande
  * @return int Renvoie normal de main
  */
-int main() {
+int main(int argc, char* argv[]) {
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
     srand(static_cast<unsigned int>(time(nullptr)));
-    int iter = 0;
-    bool fin = false;
-    vector<Joueur> joueurs;
-    Joueur::nb_joueurs=0;
-    Joueur::nb_lost=0;
-    for (int i = 0; i<NB_JOUEURS; i++)
-        joueurs.push_back(Joueur());
-    short lost = 0;
-    while(!fin) {
-        if (!joueurs[iter%joueurs.size()].hasLost()) {
-            joueurs[iter%joueurs.size()].play(joueurs[(iter+1)%joueurs.size()]);
-            fin = Joueur::nb_joueurs-Joueur::nb_lost <= 1;
+    if (argc >= 3 && string(argv[1]) == "--corpus") {
+        uint64_t nb = 0;
+        random_device rd;
+        uint64_t graine = (static_cast<uint64_t>(rd()) << 32) | rd();
+        if (!lireEntier(argv[2], nb) || (argc >= 5 && !lireEntier(argv[4], graine))) {
+            cerr << "Usage : --corpus <nombre> [fichier] [graine]" << endl;
+            return 1;
         }
-        ++iter;
+        string chemin = (argc >= 4) ? argv[3] : "corpus.bnfl";
+        Corpus corpus(graine);
+        try {
+            cout << corpus.generer(chemin, nb) << " dispositions écrites dans " << chemin << endl;
+        } catch (const exception& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (argc >= 3 && string(argv[1]) == "--parties") {
+        uint64_t nb_parties = 0;
+        uint64_t nb_threads = max(thread::hardware_concurrency(), 1u);
+        if (!lireEntier(argv[2], nb_parties) || (argc >= 4 && (!lireEntier(argv[3], nb_threads) || nb_threads == 0 || nb_threads > 1024))) {
+            cerr << "Usage : --parties <nombre> [threads entre 1 et 1024]" << endl;
+            return 1;
+        }
+        cout << nb_parties << " parties sur " << nb_threads << " threads, 's' pour un instantané" << endl;
+        Simulation simulation(nb_parties, static_cast<unsigned int>(nb_threads));
+        while (simulation.enCours()) {
+            if (_kbhit() && _getch() == 's')
+                simulation.instantane().afficher(cout);
+            this_thread::sleep_for(chrono::milliseconds(100));
+        }
+        simulation.attendre();
+        simulation.instantane().afficher(cout);
+        return 0;
+    }
+    Statistiques stats;
+    Partie partie;
+    while (!partie.finie()) {
+        partie.tour(stats.thread(0));
+        // Instantané en cours de partie en appuyant sur 's'
+        if (_kbhit() && _getch() == 's')
+            stats.instantane().afficher(cout);
     }
-    cout << ((iter>=ITER_MAX) ? "Le vainqueur est : " : "Les vainqueurs sont :\n");
-    for (int i = 0; i < static_cast<int>(joueurs.size());i++)
-        if (!joueurs[i].hasLost())
-            cout << ((iter>=ITER_MAX) ? " - " : "") << joueurs[i].getNum_joueur() << ((iter>=ITER_MAX) ? ",\n" : "");
+    stats.thread(0).terminer(partie.nbTours(), partie.vainqueurs());
+    stats.instantane().afficher(cout);
     return 0;
-}
\ No newline at end of file
+}
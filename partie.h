@@ -0,0 +1,150 @@
+/**
+ * @file partie.h
+ * @brief Déroulement d'une partie et lancement de lots de parties sur plusieurs threads
+ * @author Léopaul ESTOUR
+ * @date 18/10/2026
+ * @version V0.1
+ */
+#pragma once
+
+#include <thread>
+#include "joueur.h"
+#include "statistiques.h"
+
+/**
+ * @class Partie
+ * @brief Représente une partie, ses joueurs et le décompte des joueurs ayant perdu
+ */
+class Partie {
+    private:
+        /// Joueurs de la partie
+        vector<Joueur> joueurs;
+        /// Nombre de joueurs ayant perdu
+        unsigned short nb_lost;
+        /// Nombre de tours de joueur écoulés
+        int iter;
+
+    public:
+        /**
+         * @brief Construction d'une partie de NB_JOUEURS robots
+         *
+         * @param verbeux Définit si les joueurs affichent leurs grilles et leurs tirs
+         */
+        Partie(bool verbeux = true) : nb_lost(0), iter(0) {
+            for (unsigned short i = 0; i < NB_JOUEURS; i++)
+                joueurs.push_back(Joueur(true, i, verbeux));
+        }
+
+        /**
+         * @brief Fait jouer le joueur dont c'est le tour et enregistre son tir
+         *
+         * @param acc Accumulateur du thread courant
+         */
+        void tour(Accumulateur& acc) {
+            Joueur& joueur = joueurs[iter % joueurs.size()];
+            Joueur& ennemi = joueurs[(iter + 1) % joueurs.size()];
+            if (!joueur.hasLost()) {
+                bool dejaPerdu = ennemi.hasLost();
+                acc.enregistrer(joueur.play(ennemi));
+                if (!dejaPerdu && ennemi.hasLost()) nb_lost++;
+            }
+            ++iter;
+        }
+        /**
+         * @brief Joue la partie jusqu'au bout et enregistre son résultat
+         *
+         * @param acc Accumulateur du thread courant
+         */
+        void jouer(Accumulateur& acc) {
+            while (!finie()) tour(acc);
+            acc.terminer(nbTours(), vainqueurs());
+        }
+
+        /**
+         * @brief Renvoie si la partie est finie, c'est-à-dire s'il reste au plus un joueur
+         *
+         * @return true La partie est finie
+         * @return false La partie continue
+         */
+        bool finie() const { return joueurs.size() - nb_lost <= 1; }
+        /**
+         * @brief Renvoie le nombre de tours joués, un tour comprenant un tir de chaque joueur
+         *
+         * @return int Nombre de tours
+         */
+        int nbTours() const { return (iter + static_cast<int>(joueurs.size()) - 1) / static_cast<int>(joueurs.size()); }
+        /**
+         * @brief Renvoie les numéros des joueurs n'ayant pas perdu
+         *
+         * @return vector<unsigned short> Numéros des vainqueurs
+         */
+        vector<unsigned short> vainqueurs() {
+            vector<unsigned short> rtr;
+            for (Joueur& j : joueurs)
+                if (!j.hasLost()) rtr.push_back(j.getNum_joueur());
+            return rtr;
+        }
+};
+
+/**
+ * @class Simulation
+ * @brief Joue un lot de parties sans affichage sur plusieurs threads
+ *
+ * Le thread k joue les parties k, k + nb_threads, ... et n'écrit que dans
+ * son propre accumulateur. Les statistiques peuvent être consultées via
+ * 'instantane()' pendant que les threads jouent.
+ */
+class Simulation {
+    private:
+        /// Statistiques, un accumulateur par thread
+        Statistiques stats;
+        /// Nombre de parties à jouer
+        uint64_t nb_parties;
+        /// Threads de jeu
+        vector<thread> threads;
+
+    public:
+        /**
+         * @brief Lance 'nb_parties' parties réparties sur 'nb_threads' threads
+         *
+         * @param _nb_parties Nombre de parties à jouer
+         * @param nb_threads Nombre de threads de jeu, au moins 1
+         */
+        Simulation(uint64_t _nb_parties, unsigned int nb_threads) : stats(max(nb_threads, 1u)), nb_parties(_nb_parties) {
+            nb_threads = max(nb_threads, 1u);
+            for (unsigned int k = 0; k < nb_threads; k++)
+                threads.emplace_back([this, k, nb_threads] {
+                    for (uint64_t g = k; g < nb_parties; g += nb_threads)
+                        Partie(false).jouer(stats.thread(k));
+                });
+        }
+        Simulation(const Simulation&) = delete;
+        Simulation& operator=(const Simulation&) = delete;
+        /**
+         * @brief Attend la fin des threads avant destruction
+         *
+         */
+        ~Simulation() { attendre(); }
+
+        /**
+         * @brief Renvoie si des parties restent à terminer
+         *
+         * @return true Des parties sont en cours
+         * @return false Toutes les parties sont terminées
+         */
+        bool enCours() const { return stats.instantane().parties < nb_parties; }
+        /**
+         * @brief Fusionne les statistiques de tous les threads sans les interrompre
+         *
+         * @return Instantane Statistiques fusionnées
+         */
+        Instantane instantane() const { return stats.instantane(); }
+        /**
+         * @brief Attend la fin de tous les threads de jeu
+         *
+         */
+        void attendre() {
+            for (thread& t : threads)
+                if (t.joinable()) t.join();
+        }
+};
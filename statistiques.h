@@ -0,0 +1,250 @@
+/**
+ * @file statistiques.h
+ * @brief Agrégation sans verrou des statistiques de parties jouées en parallèle
+ * @author Léopaul ESTOUR
+ * @date 18/10/2026
+ * @version V0.1
+ */
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include "joueur.h"
+
+/// Taille d'une ligne de cache, utilisée pour isoler les accumulateurs de chaque thread
+#define TAILLE_LIGNE_CACHE 64
+/// Quantile de la loi normale utilisé pour les intervalles de confiance (95%)
+#define Z_CONFIANCE 1.96
+
+/// Noms des formes de bateaux, dans l'ordre de FLOTTE
+const string NOMS_FORMES[] = {"Porte-avion", "Croiseur", "Contre-torpilleur", "Torpilleur"};
+static_assert(sizeof(NOMS_FORMES) / sizeof(NOMS_FORMES[0]) == NB_FORMES, "Un nom par forme de FLOTTE");
+
+/**
+ * @class Instantane
+ * @brief Copie figée des statistiques fusionnées de tous les threads
+ */
+class Instantane {
+    public:
+        /// Nombre de parties terminées
+        uint64_t parties = 0;
+        /// Nombre de victoires par numéro de joueur
+        uint64_t victoires[NB_JOUEURS] = {};
+        /// Histogramme du nombre de tours pour gagner, la dernière case regroupe les parties d'au moins ITER_MAX tours
+        uint64_t tours[ITER_MAX + 1] = {};
+        /// Nombre de tirs ayant touché, par case
+        uint64_t touches[DIMENSIONS][DIMENSIONS] = {};
+        /// Nombre de tirs ratés, par case
+        uint64_t rates[DIMENSIONS][DIMENSIONS] = {};
+        /// Nombre de fois où chaque forme a été coulée à chaque rang
+        uint64_t ordre[NB_FORMES][NB_BATEAUX] = {};
+
+        /**
+         * @brief Renvoie le taux de victoire du joueur 'j'
+         *
+         * @param j numéro du joueur
+         * @return double Taux de victoire entre 0 et 1
+         */
+        double tauxVictoire(int j) const { return parties ? static_cast<double>(victoires[j]) / parties : 0.0; }
+        /**
+         * @brief Renvoie l'intervalle de confiance de Wilson à 95% du taux de victoire du joueur 'j'
+         *
+         * @param j numéro du joueur
+         * @return pair<double,double> Bornes inférieure et supérieure de l'intervalle
+         */
+        pair<double,double> intervalle(int j) const {
+            if (!parties) return {0.0, 1.0};
+            double n = static_cast<double>(parties);
+            double p = tauxVictoire(j);
+            double z2 = Z_CONFIANCE * Z_CONFIANCE;
+            double denom = 1 + z2 / n;
+            double centre = (p + z2 / (2 * n)) / denom;
+            double marge = Z_CONFIANCE * sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / denom;
+            return {max(0.0, centre - marge), min(1.0, centre + marge)};
+        }
+        /**
+         * @brief Affichage de l'instantané sur le flux 'out'
+         *
+         * Le format du flux (précision, alignement) est rétabli à la fin de l'affichage
+         *
+         * @param out Flux de sortie
+         */
+        void afficher(ostream& out) const {
+            ios::fmtflags format = out.flags();
+            streamsize precision = out.precision();
+            out << "=== Statistiques sur " << parties << " partie(s) ===\n";
+
+            out << "Taux de victoire (IC 95%) :\n";
+            for (int j = 0; j < NB_JOUEURS; j++) {
+                pair<double,double> ic = intervalle(j);
+                out << " - " << j << " : " << fixed << setprecision(1) << 100 * tauxVictoire(j) << "% [" << 100 * ic.first << "% ; " << 100 * ic.second << "%]\n";
+            }
+
+            out << "Tours pour gagner :\n";
+            for (int t = 0; t <= ITER_MAX; t++)
+                if (tours[t])
+                    out << " " << setw(3) << t << (t == ITER_MAX ? "+" : " ") << " : " << tours[t] << "\n";
+
+            out << "Ordre de naufrage (rang 1 -> " << NB_BATEAUX << ") :\n";
+            for (int f = 0; f < NB_FORMES; f++) {
+                out << " - " << setw(18) << left << NOMS_FORMES[f] << right << ":";
+                for (int r = 0; r < NB_BATEAUX; r++) out << " " << setw(5) << ordre[f][r];
+                out << "\n";
+            }
+
+            out << "Taux de touche par case (%) :\n";
+            for (int i = 0; i < DIMENSIONS; i++) {
+                out << setw(3) << i + 1 << " ";
+                for (int j = 0; j < DIMENSIONS; j++) {
+                    uint64_t tirs = touches[i][j] + rates[i][j];
+                    if (tirs) out << setw(4) << static_cast<int>(100 * touches[i][j] / tirs);
+                    else      out << setw(4) << "-";
+                }
+                out << "\n";
+            }
+            out.flags(format);
+            out.precision(precision);
+            out << endl;
+        }
+};
+
+/**
+ * @class Accumulateur
+ * @brief Compteurs d'un seul thread, lus sans verrou par les autres
+ *
+ * Chaque thread ne modifie que son propre accumulateur : un incrément est donc
+ * une simple lecture suivie d'une écriture relâchée, sans instruction atomique
+ * de type lecture-modification-écriture. Le bourrage en début et en fin
+ * d'objet évite que deux accumulateurs voisins partagent une ligne de cache.
+ */
+class Accumulateur {
+    private:
+        /// Bourrage contre le faux partage avec l'objet précédent
+        char bourrage_debut[TAILLE_LIGNE_CACHE];
+        /// Nombre de parties terminées
+        atomic<uint64_t> parties;
+        /// Nombre de victoires par numéro de joueur
+        atomic<uint64_t> victoires[NB_JOUEURS];
+        /// Histogramme du nombre de tours pour gagner
+        atomic<uint64_t> tours[ITER_MAX + 1];
+        /// Nombre de tirs ayant touché, par case
+        atomic<uint64_t> touches[DIMENSIONS][DIMENSIONS];
+        /// Nombre de tirs ratés, par case
+        atomic<uint64_t> rates[DIMENSIONS][DIMENSIONS];
+        /// Nombre de fois où chaque forme a été coulée à chaque rang
+        atomic<uint64_t> ordre[NB_FORMES][NB_BATEAUX];
+        /// Bourrage contre le faux partage avec l'objet suivant
+        char bourrage_fin[TAILLE_LIGNE_CACHE];
+
+        /**
+         * @brief Incrémente un compteur dont le thread courant est le seul écrivain
+         *
+         * @param c compteur à incrémenter
+         */
+        static void incrementer(atomic<uint64_t>& c) { c.store(c.load(memory_order_relaxed) + 1, memory_order_relaxed); }
+        /**
+         * @brief Ajoute la valeur d'un compteur à un total
+         *
+         * @param total total à compléter
+         * @param c compteur à lire
+         */
+        static void ajouter(uint64_t& total, const atomic<uint64_t>& c) { total += c.load(memory_order_relaxed); }
+
+    public:
+        /**
+         * @brief Construction d'un accumulateur dont tous les compteurs sont à 0
+         *
+         */
+        Accumulateur() : parties(0) {
+            for (auto& c : victoires) c.store(0, memory_order_relaxed);
+            for (auto& c : tours) c.store(0, memory_order_relaxed);
+            for (auto& l : touches) for (auto& c : l) c.store(0, memory_order_relaxed);
+            for (auto& l : rates) for (auto& c : l) c.store(0, memory_order_relaxed);
+            for (auto& l : ordre) for (auto& c : l) c.store(0, memory_order_relaxed);
+        }
+        Accumulateur(const Accumulateur&) = delete;
+        Accumulateur& operator=(const Accumulateur&) = delete;
+
+        /**
+         * @brief Enregistre un tir dans la carte des touches et l'ordre de naufrage
+         *
+         * @param tir Résultat du tir renvoyé par Joueur::play
+         */
+        void enregistrer(const Tir& tir) {
+            if (tir.y < 0 || tir.y >= DIMENSIONS || tir.x < 0 || tir.x >= DIMENSIONS) return;
+            incrementer(tir.touche ? touches[tir.y][tir.x] : rates[tir.y][tir.x]);
+            if (0 <= tir.forme_coulee && tir.forme_coulee < NB_FORMES && 1 <= tir.rang && tir.rang <= NB_BATEAUX)
+                incrementer(ordre[tir.forme_coulee][tir.rang - 1]);
+        }
+        /**
+         * @brief Enregistre la fin d'une partie
+         *
+         * @param nb_tours Nombre de tours joués avant la victoire
+         * @param vainqueurs Numéros des joueurs n'ayant pas perdu
+         */
+        void terminer(int nb_tours, const vector<unsigned short>& vainqueurs) {
+            incrementer(tours[min(max(nb_tours, 0), ITER_MAX)]);
+            for (unsigned short v : vainqueurs)
+                if (v < NB_JOUEURS) incrementer(victoires[v]);
+            incrementer(parties);
+        }
+        /**
+         * @brief Ajoute les compteurs de l'accumulateur à l'instantané 's'
+         *
+         * @param s Instantané à compléter
+         */
+        void fusionner(Instantane& s) const {
+            ajouter(s.parties, parties);
+            for (int j = 0; j < NB_JOUEURS; j++) ajouter(s.victoires[j], victoires[j]);
+            for (int t = 0; t <= ITER_MAX; t++) ajouter(s.tours[t], tours[t]);
+            for (int i = 0; i < DIMENSIONS; i++)
+                for (int j = 0; j < DIMENSIONS; j++) {
+                    ajouter(s.touches[i][j], touches[i][j]);
+                    ajouter(s.rates[i][j], rates[i][j]);
+                }
+            for (int f = 0; f < NB_FORMES; f++)
+                for (int r = 0; r < NB_BATEAUX; r++) ajouter(s.ordre[f][r], ordre[f][r]);
+        }
+};
+
+/**
+ * @class Statistiques
+ * @brief Ensemble des accumulateurs, un par thread de jeu
+ *
+ * Les threads écrivent chacun dans leur accumulateur via 'thread(i)' ;
+ * 'instantane()' peut être appelé à tout moment depuis n'importe quel thread
+ * sans interrompre les parties en cours. Les compteurs étant lus un à un,
+ * un instantané pris en cours de partie peut mélanger l'état de tirs voisins.
+ */
+class Statistiques {
+    private:
+        /// Accumulateurs, un par thread
+        vector<Accumulateur> accumulateurs;
+
+    public:
+        /**
+         * @brief Construction des statistiques pour 'nb_threads' threads de jeu
+         *
+         * @param nb_threads Nombre de threads écrivant des statistiques
+         */
+        Statistiques(size_t nb_threads = 1) : accumulateurs(nb_threads) {}
+        /**
+         * @brief Accède à l'accumulateur réservé au thread 'i'
+         *
+         * @param i indice du thread
+         * @return Accumulateur& Accumulateur renvoyé
+         */
+        Accumulateur& thread(size_t i) { return accumulateurs[i]; }
+        /**
+         * @brief Fusionne les accumulateurs de tous les threads
+         *
+         * @return Instantane Statistiques fusionnées
+         */
+        Instantane instantane() const {
+            Instantane s;
+            for (const Accumulateur& a : accumulateurs) a.fusionner(s);
+            return s;
+        }
+};